@@ -0,0 +1,140 @@
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "single_linked_list.h"
+#include "thread_caching_node_allocator.h"
+
+namespace {
+
+constexpr size_t kListSize = 1000;
+constexpr size_t kRoundsPerThread = 200;
+
+// Каждый поток многократно строит список через push_front и разрушает его.
+// Возвращает число выделений и освобождений узлов в секунду по всем потокам.
+template <typename List>
+double MeasureThroughput(size_t thread_count) {
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back([] {
+            for (size_t round = 0; round < kRoundsPerThread; ++round) {
+                List list;
+                for (size_t i = 0; i < kListSize; ++i) {
+                    list.push_front(static_cast<int>(i));
+                }
+                while (!list.empty()) {
+                    list.erase_after(list.before_begin());
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return 2.0 * kListSize * kRoundsPerThread * thread_count / elapsed.count();
+}
+
+// Ограниченная очередь для передачи готовых списков от производителя потребителю
+template <typename List>
+class HandoffQueue {
+public:
+    void Push(std::unique_ptr<List> list) {
+        std::unique_lock lock(mutex_);
+        not_full_.wait(lock, [this] {
+            return lists_.size() < kCapacity;
+        });
+        lists_.push_back(std::move(list));
+        not_empty_.notify_one();
+    }
+
+    std::unique_ptr<List> Pop() {
+        std::unique_lock lock(mutex_);
+        not_empty_.wait(lock, [this] {
+            return !lists_.empty();
+        });
+        auto list = std::move(lists_.front());
+        lists_.pop_front();
+        not_full_.notify_one();
+        return list;
+    }
+
+private:
+    static constexpr size_t kCapacity = 4;
+
+    std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+    std::deque<std::unique_ptr<List>> lists_;
+};
+
+// Половина потоков строит списки и передаёт их через очередь своей пары другой половине,
+// которая одновременно с этим их разрушает: все освобождения происходят не в том потоке,
+// где было выделение. thread_count - число одновременно работающих потоков (чётное).
+template <typename List>
+double MeasureCrossThroughput(size_t thread_count) {
+    const size_t pair_count = thread_count / 2;
+    std::vector<HandoffQueue<List>> queues(pair_count);
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    const auto start = std::chrono::steady_clock::now();
+    for (auto &queue : queues) {
+        threads.emplace_back([&queue] {
+            for (size_t round = 0; round < kRoundsPerThread; ++round) {
+                auto list = std::make_unique<List>();
+                for (size_t i = 0; i < kListSize; ++i) {
+                    list->push_front(static_cast<int>(i));
+                }
+                queue.Push(std::move(list));
+            }
+        });
+        threads.emplace_back([&queue] {
+            for (size_t round = 0; round < kRoundsPerThread; ++round) {
+                queue.Pop()->clear();
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return 2.0 * kListSize * kRoundsPerThread * pair_count / elapsed.count();
+}
+
+template <typename Measure>
+void PrintScaling(const char *title, size_t min_threads, Measure measure_default, Measure measure_caching) {
+    std::cout << title << " (Mops/s)" << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(12) << "default"
+              << std::setw(12) << "caching" << std::setw(10) << "speedup" << std::endl;
+    for (size_t threads = min_threads; threads <= 32; threads *= 2) {
+        const double default_ops = measure_default(threads);
+        const double caching_ops = measure_caching(threads);
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(2)
+                  << std::setw(12) << default_ops / 1e6
+                  << std::setw(12) << caching_ops / 1e6
+                  << std::setw(9) << caching_ops / default_ops << 'x' << std::endl;
+    }
+}
+
+}  // namespace
+
+int main() {
+    using DefaultList = SingleLinkedList<int>;
+    using CachingList = SingleLinkedList<int, ThreadCachingNodeAllocator<>>;
+
+    PrintScaling("push_front + erase_after in the same thread", 1,
+                 &MeasureThroughput<DefaultList>, &MeasureThroughput<CachingList>);
+    std::cout << std::endl;
+    PrintScaling("allocate in one thread, free in another concurrently", 2,
+                 &MeasureCrossThroughput<DefaultList>, &MeasureCrossThroughput<CachingList>);
+}
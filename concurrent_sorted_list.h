@@ -0,0 +1,567 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+// Стратегии синхронизации для ConcurrentSortedList
+struct HandOverHandLocking {};       // блокировка по цепочке: не больше двух захваченных узлов за раз
+struct LazySynchronization {};       // оптимистичный обход без блокировок и ленивое удаление (Heller et al.)
+struct LockFreeSynchronization {};   // без блокировок, помеченные указатели (Harris)
+
+// Упорядоченное множество на односвязном списке, к которому могут обращаться несколько потоков сразу.
+// Элементы сравниваются с помощью operator<.
+template <typename Type, typename Strategy = LazySynchronization>
+class ConcurrentSortedList;
+
+// Номер слота текущего потока среди одновременно живых потоков. Номер возвращается в общий пул
+// при завершении потока и достаётся следующему потоку вместе с его неосвобождёнными узлами.
+class ThreadSlotRegistry {
+public:
+    static constexpr size_t kMaxThreads = 256;
+
+    static size_t ThisThreadSlot() {
+        thread_local SlotHolder holder;
+        return holder.slot;
+    }
+
+    // Число слотов, которые когда-либо были выданы
+    static size_t UsedSlots() noexcept {
+        return Instance().used_.load(std::memory_order_acquire);
+    }
+
+private:
+    struct SlotHolder {
+        SlotHolder() : slot(Instance().Acquire()) {}
+
+        ~SlotHolder() {
+            Instance().Release(slot);
+        }
+
+        size_t slot;
+    };
+
+    // Реестр намеренно не разрушается: потоки могут завершаться после разрушения статических объектов
+    static ThreadSlotRegistry &Instance() {
+        static ThreadSlotRegistry *registry = new ThreadSlotRegistry;
+        return *registry;
+    }
+
+    size_t Acquire() {
+        std::lock_guard guard(mutex_);
+        if (free_count_ > 0) {
+            return free_slots_[--free_count_];
+        }
+        const size_t slot = used_.load(std::memory_order_relaxed);
+        if (slot == kMaxThreads) {
+            throw std::length_error("too many threads use ConcurrentSortedList at once");
+        }
+        used_.store(slot + 1, std::memory_order_release);
+        return slot;
+    }
+
+    void Release(size_t slot) noexcept {
+        std::lock_guard guard(mutex_);
+        free_slots_[free_count_++] = slot;
+    }
+
+    std::mutex mutex_;
+    std::array<size_t, kMaxThreads> free_slots_{};
+    size_t free_count_ = 0;
+    std::atomic<size_t> used_ = 0;
+};
+
+// Освобождение исключённых из списка узлов по эпохам (Fraser). Каждая операция над списком
+// выполняется внутри Guard, который отмечает в слоте потока глобальную эпоху на момент входа.
+// Узел, исключённый в эпоху e, освобождается, когда глобальная эпоха достигнет e + 2: к этому
+// моменту все потоки, которые могли его видеть, уже вышли из своих операций.
+// Неосвобождённых узлов не больше нескольких пачек по kRetireBatch на каждый слот, если ни один
+// поток не застревает внутри операции.
+template <typename Node>
+class EpochReclaimer {
+    static constexpr uint64_t kInactive = 0;
+    static constexpr size_t kRetireBatch = 64;
+
+    struct RetiredBucket {
+        Node *head = nullptr;
+        uint64_t epoch = 0;
+    };
+
+    struct alignas(64) Slot {
+        // (эпоха << 1) | 1 во время операции, kInactive вне её
+        std::atomic<uint64_t> state = kInactive;
+        // Корзины трогает только поток, владеющий слотом
+        std::array<RetiredBucket, 3> buckets;
+        size_t retired_since_advance = 0;
+    };
+
+public:
+    class Guard {
+    public:
+        explicit Guard(EpochReclaimer &reclaimer)
+                : reclaimer_(reclaimer)
+                , slot_(reclaimer.slots_[ThreadSlotRegistry::ThisThreadSlot()]) {
+            slot_.state.store((reclaimer_.epoch_.load() << 1) | 1,
+                              std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        Guard(const Guard &) = delete;
+
+        Guard &operator=(const Guard &) = delete;
+
+        ~Guard() {
+            slot_.state.store(kInactive, std::memory_order_release);
+        }
+
+        // node уже исключён из списка и больше не достижим из головы
+        void Retire(Node *node) noexcept {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const uint64_t epoch = reclaimer_.epoch_.load();
+            RetiredBucket &bucket = slot_.buckets[epoch % 3];
+            if (bucket.epoch != epoch) {
+                // В корзине узлы эпохи не позже epoch - 3
+                FreeBucket(bucket);
+                bucket.epoch = epoch;
+            }
+            node->retired_next = bucket.head;
+            bucket.head = node;
+            if (++slot_.retired_since_advance == kRetireBatch) {
+                slot_.retired_since_advance = 0;
+                reclaimer_.TryAdvance();
+                const uint64_t current = reclaimer_.epoch_.load(std::memory_order_acquire);
+                for (RetiredBucket &other : slot_.buckets) {
+                    if (other.epoch + 2 <= current) {
+                        FreeBucket(other);
+                    }
+                }
+            }
+        }
+
+    private:
+        EpochReclaimer &reclaimer_;
+        Slot &slot_;
+    };
+
+    EpochReclaimer() = default;
+
+    EpochReclaimer(const EpochReclaimer &) = delete;
+
+    EpochReclaimer &operator=(const EpochReclaimer &) = delete;
+
+    ~EpochReclaimer() {
+        Reclaim();
+    }
+
+    // Освобождает все исключённые узлы. Нельзя вызывать одновременно с операциями над списком
+    void Reclaim() noexcept {
+        for (Slot &slot : slots_) {
+            for (RetiredBucket &bucket : slot.buckets) {
+                FreeBucket(bucket);
+            }
+        }
+    }
+
+private:
+    static void FreeBucket(RetiredBucket &bucket) noexcept {
+        while (bucket.head) {
+            delete std::exchange(bucket.head, bucket.head->retired_next);
+        }
+    }
+
+    void TryAdvance() noexcept {
+        uint64_t epoch = epoch_.load();
+        const size_t used = ThreadSlotRegistry::UsedSlots();
+        for (size_t i = 0; i < used; ++i) {
+            const uint64_t state = slots_[i].state.load();
+            if (state != kInactive && (state >> 1) != epoch) {
+                return;
+            }
+        }
+        epoch_.compare_exchange_strong(epoch, epoch + 1);
+    }
+
+    std::atomic<uint64_t> epoch_ = 0;
+    std::array<Slot, ThreadSlotRegistry::kMaxThreads> slots_;
+};
+
+template <typename Type>
+class ConcurrentSortedList<Type, HandOverHandLocking> {
+    struct Node {
+        Node() = default;
+
+        Node(const Type &val, Node *next) : value(val), next_node(next) {}
+
+        Type value;
+        Node *next_node = nullptr;
+        std::mutex mutex;
+    };
+
+public:
+    ConcurrentSortedList() = default;
+
+    ConcurrentSortedList(const ConcurrentSortedList &) = delete;
+
+    ConcurrentSortedList &operator=(const ConcurrentSortedList &) = delete;
+
+    ~ConcurrentSortedList() {
+        while (head_.next_node) {
+            delete std::exchange(head_.next_node, head_.next_node->next_node);
+        }
+    }
+
+    bool insert(const Type &value) {
+        auto [pred, curr] = LockPosition(value);
+        std::unique_lock pred_lock(pred->mutex, std::adopt_lock);
+        std::unique_lock<std::mutex> curr_lock;
+        if (curr) {
+            curr_lock = std::unique_lock(curr->mutex, std::adopt_lock);
+            if (!(value < curr->value)) {
+                return false;
+            }
+        }
+        pred->next_node = new Node(value, curr);
+        size_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool erase(const Type &value) {
+        auto [pred, curr] = LockPosition(value);
+        std::unique_lock pred_lock(pred->mutex, std::adopt_lock);
+        if (!curr) {
+            return false;
+        }
+        std::unique_lock curr_lock(curr->mutex, std::adopt_lock);
+        if (value < curr->value) {
+            return false;
+        }
+        pred->next_node = curr->next_node;
+        // Добраться до curr можно только через захваченный pred, поэтому узел можно удалить сразу
+        curr_lock.unlock();
+        delete curr;
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    [[nodiscard]] bool contains(const Type &value) const {
+        auto [pred, curr] = LockPosition(value);
+        std::unique_lock pred_lock(pred->mutex, std::adopt_lock);
+        if (!curr) {
+            return false;
+        }
+        std::unique_lock curr_lock(curr->mutex, std::adopt_lock);
+        return !(value < curr->value);
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+private:
+    // Возвращает захваченные узлы pred и curr, где curr - первый узел не меньше value (или nullptr)
+    std::pair<Node *, Node *> LockPosition(const Type &value) const {
+        Node *pred = &head_;
+        pred->mutex.lock();
+        Node *curr = pred->next_node;
+        if (curr) {
+            curr->mutex.lock();
+        }
+        while (curr && curr->value < value) {
+            pred->mutex.unlock();
+            pred = curr;
+            curr = curr->next_node;
+            if (curr) {
+                curr->mutex.lock();
+            }
+        }
+        return {pred, curr};
+    }
+
+    mutable Node head_;
+    std::atomic<size_t> size_ = 0;
+};
+
+template <typename Type>
+class ConcurrentSortedList<Type, LazySynchronization> {
+    struct Node {
+        Node() = default;
+
+        Node(const Type &val, Node *next) : value(val), next_node(next) {}
+
+        Type value;
+        std::atomic<Node *> next_node = nullptr;
+        std::atomic<bool> marked = false;
+        std::mutex mutex;
+        Node *retired_next = nullptr;
+    };
+
+    using Guard = typename EpochReclaimer<Node>::Guard;
+
+public:
+    ConcurrentSortedList() = default;
+
+    ConcurrentSortedList(const ConcurrentSortedList &) = delete;
+
+    ConcurrentSortedList &operator=(const ConcurrentSortedList &) = delete;
+
+    ~ConcurrentSortedList() {
+        Node *node = head_.next_node.load(std::memory_order_acquire);
+        while (node) {
+            delete std::exchange(node, node->next_node.load(std::memory_order_relaxed));
+        }
+    }
+
+    bool insert(const Type &value) {
+        Guard guard(reclaimer_);
+        while (true) {
+            auto [pred, curr] = Find(value);
+            std::lock_guard pred_lock(pred->mutex);
+            std::unique_lock<std::mutex> curr_lock;
+            if (curr) {
+                curr_lock = std::unique_lock(curr->mutex);
+            }
+            if (!Validate(pred, curr)) {
+                continue;
+            }
+            if (curr && !(value < curr->value)) {
+                return false;
+            }
+            pred->next_node.store(new Node(value, curr), std::memory_order_release);
+            size_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    bool erase(const Type &value) {
+        Guard guard(reclaimer_);
+        while (true) {
+            auto [pred, curr] = Find(value);
+            std::lock_guard pred_lock(pred->mutex);
+            if (!curr) {
+                if (!Validate(pred, curr)) {
+                    continue;
+                }
+                return false;
+            }
+            std::lock_guard curr_lock(curr->mutex);
+            if (!Validate(pred, curr)) {
+                continue;
+            }
+            if (value < curr->value) {
+                return false;
+            }
+            // Сначала логическое удаление, затем физическое
+            curr->marked.store(true, std::memory_order_release);
+            pred->next_node.store(curr->next_node.load(std::memory_order_relaxed), std::memory_order_release);
+            guard.Retire(curr);
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    [[nodiscard]] bool contains(const Type &value) const {
+        Guard guard(reclaimer_);
+        Node *curr = head_.next_node.load(std::memory_order_acquire);
+        while (curr && curr->value < value) {
+            curr = curr->next_node.load(std::memory_order_acquire);
+        }
+        return curr && !(value < curr->value) && !curr->marked.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    // Освобождает узлы, удалённые, но ещё не освобождённые механизмом эпох.
+    // Нельзя вызывать одновременно с другими операциями над множеством
+    void Reclaim() noexcept {
+        reclaimer_.Reclaim();
+    }
+
+private:
+    std::pair<Node *, Node *> Find(const Type &value) {
+        Node *pred = &head_;
+        Node *curr = pred->next_node.load(std::memory_order_acquire);
+        while (curr && curr->value < value) {
+            pred = curr;
+            curr = curr->next_node.load(std::memory_order_acquire);
+        }
+        return {pred, curr};
+    }
+
+    static bool Validate(const Node *pred, const Node *curr) noexcept {
+        return !pred->marked.load(std::memory_order_acquire)
+               && (!curr || !curr->marked.load(std::memory_order_acquire))
+               && pred->next_node.load(std::memory_order_acquire) == curr;
+    }
+
+    Node head_;
+    mutable EpochReclaimer<Node> reclaimer_;
+    std::atomic<size_t> size_ = 0;
+};
+
+template <typename Type>
+class ConcurrentSortedList<Type, LockFreeSynchronization> {
+    struct Node {
+        Node() = default;
+
+        Node(const Type &val, Node *next) : value(val), next_node(reinterpret_cast<uintptr_t>(next)) {}
+
+        Type value;
+        // Указатель на следующий узел; младший бит - пометка логического удаления самого узла
+        std::atomic<uintptr_t> next_node = 0;
+        Node *retired_next = nullptr;
+    };
+
+    static_assert(alignof(Node) > 1);
+
+    using Guard = typename EpochReclaimer<Node>::Guard;
+
+public:
+    ConcurrentSortedList() = default;
+
+    ConcurrentSortedList(const ConcurrentSortedList &) = delete;
+
+    ConcurrentSortedList &operator=(const ConcurrentSortedList &) = delete;
+
+    ~ConcurrentSortedList() {
+        Node *node = ToNode(head_.next_node.load(std::memory_order_acquire));
+        while (node) {
+            delete std::exchange(node, ToNode(node->next_node.load(std::memory_order_relaxed)));
+        }
+    }
+
+    bool insert(const Type &value) {
+        Guard guard(reclaimer_);
+        Node *new_node = new Node(value, nullptr);
+        while (true) {
+            auto [pred, curr] = Find(value, guard);
+            if (curr && !(value < curr->value)) {
+                delete new_node;
+                return false;
+            }
+            new_node->next_node.store(ToLink(curr), std::memory_order_relaxed);
+            uintptr_t expected = ToLink(curr);
+            if (pred->next_node.compare_exchange_strong(expected, ToLink(new_node),
+                                                        std::memory_order_release, std::memory_order_relaxed)) {
+                size_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+
+    bool erase(const Type &value) {
+        Guard guard(reclaimer_);
+        while (true) {
+            auto [pred, curr] = Find(value, guard);
+            if (!curr || value < curr->value) {
+                return false;
+            }
+            uintptr_t succ = curr->next_node.load(std::memory_order_acquire);
+            if (IsMarked(succ)) {
+                continue;
+            }
+            // Логическое удаление: помечаем ссылку из удаляемого узла
+            if (!curr->next_node.compare_exchange_strong(succ, succ | kMarkBit,
+                                                         std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                continue;
+            }
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            uintptr_t expected = ToLink(curr);
+            if (pred->next_node.compare_exchange_strong(expected, succ,
+                                                        std::memory_order_release, std::memory_order_relaxed)) {
+                guard.Retire(curr);
+            } else {
+                // Физически исключит узел тот, кто следующим пройдёт по этому месту
+                Find(value, guard);
+            }
+            return true;
+        }
+    }
+
+    [[nodiscard]] bool contains(const Type &value) const {
+        Guard guard(reclaimer_);
+        Node *curr = ToNode(head_.next_node.load(std::memory_order_acquire));
+        while (curr && curr->value < value) {
+            curr = ToNode(curr->next_node.load(std::memory_order_acquire));
+        }
+        return curr && !(value < curr->value) && !IsMarked(curr->next_node.load(std::memory_order_acquire));
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    // Освобождает узлы, удалённые, но ещё не освобождённые механизмом эпох.
+    // Нельзя вызывать одновременно с другими операциями над множеством
+    void Reclaim() noexcept {
+        reclaimer_.Reclaim();
+    }
+
+private:
+    static constexpr uintptr_t kMarkBit = 1;
+
+    static Node *ToNode(uintptr_t link) noexcept {
+        return reinterpret_cast<Node *>(link & ~kMarkBit);
+    }
+
+    static uintptr_t ToLink(Node *node) noexcept {
+        return reinterpret_cast<uintptr_t>(node);
+    }
+
+    static bool IsMarked(uintptr_t link) noexcept {
+        return (link & kMarkBit) != 0;
+    }
+
+    // Возвращает соседние непомеченные узлы pred и curr, где curr - первый узел не меньше value
+    // (или nullptr). По пути исключает из списка помеченные узлы.
+    std::pair<Node *, Node *> Find(const Type &value, Guard &guard) {
+        while (true) {
+            Node *pred = &head_;
+            Node *curr = ToNode(pred->next_node.load(std::memory_order_acquire));
+            bool restart = false;
+            while (curr) {
+                uintptr_t succ = curr->next_node.load(std::memory_order_acquire);
+                if (IsMarked(succ)) {
+                    uintptr_t expected = ToLink(curr);
+                    if (!pred->next_node.compare_exchange_strong(expected, succ & ~kMarkBit,
+                                                                 std::memory_order_acq_rel,
+                                                                 std::memory_order_relaxed)) {
+                        restart = true;
+                        break;
+                    }
+                    guard.Retire(curr);
+                    curr = ToNode(succ);
+                    continue;
+                }
+                if (!(curr->value < value)) {
+                    break;
+                }
+                pred = curr;
+                curr = ToNode(succ);
+            }
+            if (!restart) {
+                return {pred, curr};
+            }
+        }
+    }
+
+    Node head_;
+    mutable EpochReclaimer<Node> reclaimer_;
+    std::atomic<size_t> size_ = 0;
+};
@@ -0,0 +1,125 @@
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "concurrent_sorted_list.h"
+#include "single_linked_list.h"
+
+namespace {
+
+constexpr int kKeyRange = 512;
+constexpr size_t kOperationsPerThread = 5000;
+
+// Упорядоченный SingleLinkedList под одним общим мьютексом - исходный вариант для сравнения
+class GloballyLockedSortedList {
+public:
+    bool insert(int value) {
+        std::lock_guard guard(mutex_);
+        auto [pred, curr] = Find(value);
+        if (curr != list_.end() && *curr == value) {
+            return false;
+        }
+        list_.insert_after(pred, value);
+        return true;
+    }
+
+    bool erase(int value) {
+        std::lock_guard guard(mutex_);
+        auto [pred, curr] = Find(value);
+        if (curr == list_.end() || *curr != value) {
+            return false;
+        }
+        list_.erase_after(pred);
+        return true;
+    }
+
+    [[nodiscard]] bool contains(int value) {
+        std::lock_guard guard(mutex_);
+        auto curr = Find(value).second;
+        return curr != list_.end() && *curr == value;
+    }
+
+private:
+    std::pair<SingleLinkedList<int>::Iterator, SingleLinkedList<int>::Iterator> Find(int value) {
+        auto pred = list_.before_begin();
+        auto curr = list_.begin();
+        while (curr != list_.end() && *curr < value) {
+            pred = curr++;
+        }
+        return {pred, curr};
+    }
+
+    std::mutex mutex_;
+    SingleLinkedList<int> list_;
+};
+
+// Доли операций в процентах; остаток приходится на contains
+struct Workload {
+    const char *name;
+    unsigned insert_percent;
+    unsigned erase_percent;
+};
+
+template <typename Set>
+double MeasureThroughput(const Workload &workload, size_t thread_count) {
+    Set set;
+    for (int key = 0; key < kKeyRange; key += 2) {
+        set.insert(key);
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&set, &workload, t] {
+            unsigned state = 12345u + static_cast<unsigned>(t);
+            for (size_t i = 0; i < kOperationsPerThread; ++i) {
+                state = state * 1103515245u + 12345u;
+                const int key = static_cast<int>((state >> 16) % kKeyRange);
+                const unsigned dice = (state >> 4) % 100;
+                if (dice < workload.insert_percent) {
+                    set.insert(key);
+                } else if (dice < workload.insert_percent + workload.erase_percent) {
+                    set.erase(key);
+                } else {
+                    static_cast<void>(set.contains(key));
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return kOperationsPerThread * thread_count / elapsed.count();
+}
+
+void PrintScaling(const Workload &workload) {
+    std::cout << workload.name << ": " << workload.insert_percent << "% insert, "
+              << workload.erase_percent << "% erase (Mops/s)" << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(14) << "global-lock" << std::setw(16) << "hand-over-hand"
+              << std::setw(10) << "lazy" << std::setw(12) << "lock-free" << std::endl;
+    for (size_t threads = 1; threads <= 32; threads *= 2) {
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(3)
+                  << std::setw(14) << MeasureThroughput<GloballyLockedSortedList>(workload, threads) / 1e6
+                  << std::setw(16)
+                  << MeasureThroughput<ConcurrentSortedList<int, HandOverHandLocking>>(workload, threads) / 1e6
+                  << std::setw(10)
+                  << MeasureThroughput<ConcurrentSortedList<int, LazySynchronization>>(workload, threads) / 1e6
+                  << std::setw(12)
+                  << MeasureThroughput<ConcurrentSortedList<int, LockFreeSynchronization>>(workload, threads) / 1e6
+                  << std::endl;
+    }
+}
+
+}  // namespace
+
+int main() {
+    PrintScaling({"read-heavy", 9, 1});
+    std::cout << std::endl;
+    PrintScaling({"write-heavy", 50, 50});
+}
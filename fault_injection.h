@@ -0,0 +1,280 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "single_linked_list.h"
+
+// Вид операции, в которую внедряется сбой
+enum class FaultKind {
+    kAllocation,
+    kCopy,
+};
+
+// Счётчики выделений, копирований и живых объектов, а также точка внедрения сбоя.
+// Один экземпляр на программу; не предназначен для использования из нескольких потоков.
+class FaultInjector {
+public:
+    static FaultInjector &Instance() noexcept {
+        static FaultInjector injector;
+        return injector;
+    }
+
+    // Следующая fail_at-я операция вида kind (начиная с 1) выбросит std::bad_alloc.
+    // При fail_at == 0 операции только подсчитываются
+    void Arm(FaultKind kind, size_t fail_at) noexcept {
+        kind_ = kind;
+        fail_at_ = fail_at;
+        operations_ = 0;
+        armed_ = true;
+    }
+
+    void Disarm() noexcept {
+        armed_ = false;
+    }
+
+    void OnAllocate() {
+        OnOperation(FaultKind::kAllocation);
+        ++live_nodes_;
+    }
+
+    void OnDeallocate() noexcept {
+        --live_nodes_;
+    }
+
+    void OnCopy() {
+        OnOperation(FaultKind::kCopy);
+    }
+
+    void OnConstructValue() noexcept {
+        ++live_values_;
+    }
+
+    void OnDestroyValue() noexcept {
+        --live_values_;
+    }
+
+    // Число операций отслеживаемого вида с момента последнего Arm
+    [[nodiscard]] size_t Operations() const noexcept {
+        return operations_;
+    }
+
+    [[nodiscard]] size_t Failures() const noexcept {
+        return failures_;
+    }
+
+    [[nodiscard]] long LiveNodes() const noexcept {
+        return live_nodes_;
+    }
+
+    [[nodiscard]] long LiveValues() const noexcept {
+        return live_values_;
+    }
+
+    void ResetFailures() noexcept {
+        failures_ = 0;
+    }
+
+private:
+    void OnOperation(FaultKind kind) {
+        if (!armed_ || kind != kind_) {
+            return;
+        }
+        if (++operations_ == fail_at_) {
+            ++failures_;
+            throw std::bad_alloc();
+        }
+    }
+
+    FaultKind kind_ = FaultKind::kAllocation;
+    size_t fail_at_ = 0;
+    size_t operations_ = 0;
+    size_t failures_ = 0;
+    bool armed_ = false;
+    long live_nodes_ = 0;
+    long live_values_ = 0;
+};
+
+// Политика выделения узлов, которая подсчитывает живые узлы и может отказать в выделении
+struct FaultInjectingNodeAllocator {
+    template <typename Node, typename... Args>
+    static Node *Create(Args &&... args) {
+        FaultInjector::Instance().OnAllocate();
+        try {
+            return DefaultNodeAllocator::Create<Node>(std::forward<Args>(args)...);
+        } catch (...) {
+            FaultInjector::Instance().OnDeallocate();
+            throw;
+        }
+    }
+
+    template <typename Node>
+    static void Destroy(Node *node) noexcept {
+        DefaultNodeAllocator::Destroy(node);
+        FaultInjector::Instance().OnDeallocate();
+    }
+};
+
+// Элемент списка, который подсчитывает живые экземпляры и может выбросить исключение при копировании
+class FaultInjectingValue {
+public:
+    FaultInjectingValue() noexcept {
+        FaultInjector::Instance().OnConstructValue();
+    }
+
+    explicit FaultInjectingValue(int value) noexcept
+            : value_(value) {
+        FaultInjector::Instance().OnConstructValue();
+    }
+
+    FaultInjectingValue(const FaultInjectingValue &other)
+            : value_(other.value_) {
+        FaultInjector::Instance().OnCopy();
+        FaultInjector::Instance().OnConstructValue();
+    }
+
+    FaultInjectingValue &operator=(const FaultInjectingValue &rhs) {
+        FaultInjector::Instance().OnCopy();
+        value_ = rhs.value_;
+        return *this;
+    }
+
+    ~FaultInjectingValue() {
+        FaultInjector::Instance().OnDestroyValue();
+    }
+
+    [[nodiscard]] int Get() const noexcept {
+        return value_;
+    }
+
+private:
+    int value_ = 0;
+};
+
+inline bool operator==(const FaultInjectingValue &lhs, const FaultInjectingValue &rhs) noexcept {
+    return lhs.Get() == rhs.Get();
+}
+
+inline bool operator<(const FaultInjectingValue &lhs, const FaultInjectingValue &rhs) noexcept {
+    return lhs.Get() < rhs.Get();
+}
+
+// Номера операций, в которые стоит внедрить сбой, если всего их total:
+// несколько первых, несколько последних и равномерная выборка между ними
+inline std::vector<size_t> FailurePoints(size_t total, size_t samples = 64) {
+    std::vector<size_t> points;
+    const size_t edge = std::min<size_t>(total, 8);
+    for (size_t i = 1; i <= edge; ++i) {
+        points.push_back(i);
+        points.push_back(total + 1 - i);
+    }
+    const size_t step = std::max<size_t>(total / samples, 1);
+    for (size_t i = step; i <= total; i += step) {
+        points.push_back(i);
+    }
+    std::sort(points.begin(), points.end());
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    return points;
+}
+
+// Точка внедрения сбоя, которую ForEachInjectedFault передаёт в проверку
+class FaultPoint {
+public:
+    FaultPoint(FaultKind kind, size_t fail_at) noexcept
+            : kind_(kind)
+            , fail_at_(fail_at) {
+    }
+
+    // Вызывает проверяемый метод со сбоем в fail_at-й операции вида kind (при fail_at == 0 без сбоя).
+    // Возвращает true, если метод выбросил std::bad_alloc
+    template <typename Member>
+    bool Invoke(Member member) const {
+        auto &injector = FaultInjector::Instance();
+        injector.Arm(kind_, fail_at_);
+        try {
+            member();
+        } catch (const std::bad_alloc &) {
+            injector.Disarm();
+            return true;
+        } catch (...) {
+            injector.Disarm();
+            throw;
+        }
+        injector.Disarm();
+        return false;
+    }
+
+    [[nodiscard]] size_t FailAt() const noexcept {
+        return fail_at_;
+    }
+
+private:
+    FaultKind kind_;
+    size_t fail_at_;
+};
+
+// Вызывает action(fault) сначала без сбоя, чтобы узнать, сколько операций вида kind выполняет
+// проверяемый метод, а затем со сбоем в каждой точке из FailurePoints.
+// action создаёт исходные объекты, вызывает проверяемый метод через fault.Invoke и, если тот
+// выбросил исключение, проверяет гарантии безопасности.
+// После каждого вызова проверяется, что сбой произошёл ровно один раз и не осталось утечек.
+// Возвращает число операций проверяемого метода.
+template <typename Action>
+size_t ForEachInjectedFault(FaultKind kind, Action action) {
+    auto &injector = FaultInjector::Instance();
+    injector.ResetFailures();
+    action(FaultPoint(kind, 0));
+    const size_t total = injector.Operations();
+    assert(injector.Failures() == 0);
+    assert(injector.LiveNodes() == 0);
+    assert(injector.LiveValues() == 0);
+
+    for (size_t fail_at : FailurePoints(total)) {
+        injector.ResetFailures();
+        action(FaultPoint(kind, fail_at));
+        assert(injector.Failures() == 1);
+        assert(injector.LiveNodes() == 0);
+        assert(injector.LiveValues() == 0);
+    }
+    return total;
+}
+
+// Список из значений 0, 1, ..., size - 1
+template <typename List>
+List MakeFaultInjectingList(size_t size) {
+    List list;
+    auto pos = list.before_begin();
+    for (size_t i = 0; i < size; ++i) {
+        pos = list.insert_after(pos, FaultInjectingValue(static_cast<int>(i)));
+    }
+    return list;
+}
+
+template <typename List>
+std::vector<int> ToValues(const List &list) {
+    std::vector<int> values;
+    for (const FaultInjectingValue &value : list) {
+        values.push_back(value.Get());
+    }
+    return values;
+}
+
+// Проверка инвариантов списка после исключения (базовая гарантия): размер совпадает с числом узлов
+template <typename List>
+bool IsConsistent(const List &list) {
+    return static_cast<size_t>(std::distance(list.begin(), list.end())) == list.size();
+}
+
+// Проверка строгой гарантии: содержимое списка совпадает с сохранённым до вызова метода
+template <typename List>
+bool HasValues(const List &list, const std::vector<int> &values) {
+    return IsConsistent(list)
+           && std::equal(list.begin(), list.end(), values.begin(), values.end(),
+                         [](const FaultInjectingValue &lhs, int rhs) {
+                             return lhs.Get() == rhs;
+                         });
+}
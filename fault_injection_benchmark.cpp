@@ -0,0 +1,143 @@
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+#include "fault_injection.h"
+#include "single_linked_list.h"
+
+namespace {
+
+using PlainList = SingleLinkedList<int>;
+using InjectingList = SingleLinkedList<FaultInjectingValue, FaultInjectingNodeAllocator>;
+
+constexpr size_t kSize = 100000;
+constexpr size_t kSingleOperationCount = 100000;
+constexpr size_t kBulkRepetitions = 20;
+
+template <typename Function>
+double MeasureNs(Function function, size_t repetitions) {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < repetitions; ++i) {
+        function();
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / repetitions;
+}
+
+// Отрицательное fail_middle_ns означает, что у операции нет середины
+void PrintRow(const std::string &name, double plain_ns, double success_ns, double fail_first_ns,
+              double fail_middle_ns) {
+    std::cout << std::setw(22) << std::left << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << plain_ns << std::setw(12) << success_ns
+              << std::setw(12) << fail_first_ns << std::setw(14);
+    if (fail_middle_ns < 0) {
+        std::cout << "-";
+    } else {
+        std::cout << fail_middle_ns;
+    }
+    std::cout << std::endl;
+}
+
+// Одиночные вставки: стоимость успешного вызова и вызова, в котором выброшено исключение
+template <typename Insert>
+void ReportSingleInsert(const std::string &name, FaultKind kind, Insert insert) {
+    PlainList plain_list;
+    const double plain_ns = MeasureNs([&plain_list, &insert] {
+        insert(plain_list, 1);
+    }, kSingleOperationCount);
+
+    InjectingList list;
+    const FaultInjectingValue value(1);
+    const double success_ns = MeasureNs([&list, &insert, &value] {
+        insert(list, value);
+    }, kSingleOperationCount);
+
+    const FaultPoint fail_first(kind, 1);
+    const double fail_ns = MeasureNs([&list, &insert, &value, &fail_first] {
+        fail_first.Invoke([&list, &insert, &value] {
+            insert(list, value);
+        });
+    }, kSingleOperationCount);
+    PrintRow(name, plain_ns, success_ns, fail_ns, -1.0);
+}
+
+// Операции над всем списком: стоимость в пересчёте на элемент для успешного вызова
+// и для вызова, прерванного на середине (включая откат уже сделанной работы).
+// operation(source, fault) готовит объекты и вызывает измеряемый метод через fault.Invoke,
+// так что сбой внедряется только в сам метод, а не в подготовку
+template <typename Operation>
+void ReportBulk(const std::string &name, FaultKind kind, Operation operation) {
+    const auto plain_source = [] {
+        PlainList list;
+        auto pos = list.before_begin();
+        for (size_t i = 0; i < kSize; ++i) {
+            pos = list.insert_after(pos, static_cast<int>(i));
+        }
+        return list;
+    }();
+    const auto source = MakeFaultInjectingList<InjectingList>(kSize);
+
+    const FaultPoint no_fault(kind, 0);
+    const FaultPoint fail_first(kind, 1);
+    const FaultPoint fail_middle(kind, kSize / 2);
+    const double plain_ns = MeasureNs([&plain_source, &operation, &no_fault] {
+        operation(plain_source, no_fault);
+    }, kBulkRepetitions) / kSize;
+    const double success_ns = MeasureNs([&source, &operation, &no_fault] {
+        operation(source, no_fault);
+    }, kBulkRepetitions) / kSize;
+    const double fail_first_ns = MeasureNs([&source, &operation, &fail_first] {
+        operation(source, fail_first);
+    }, kBulkRepetitions);
+    const double fail_middle_ns = MeasureNs([&source, &operation, &fail_middle] {
+        operation(source, fail_middle);
+    }, kBulkRepetitions) / (kSize / 2);
+    PrintRow(name, plain_ns, success_ns, fail_first_ns, fail_middle_ns);
+}
+
+void Report(FaultKind kind) {
+    std::cout << "Injected fault: " << (kind == FaultKind::kAllocation ? "node allocation" : "value copy")
+              << ", list size " << kSize << std::endl;
+    std::cout << std::setw(22) << std::left << "member" << std::right << std::setw(12) << "plain"
+              << std::setw(12) << "success" << std::setw(12) << "fail@1" << std::setw(14) << "fail@50%" << std::endl;
+
+    ReportSingleInsert("push_front (ns/call)", kind, [](auto &list, const auto &value) {
+        list.push_front(value);
+    });
+    ReportSingleInsert("insert_after (ns/call)", kind, [](auto &list, const auto &value) {
+        list.insert_after(list.cbefore_begin(), value);
+    });
+    ReportBulk("copy ctor (ns/elem)", kind, [](const auto &source, const FaultPoint &fault) {
+        fault.Invoke([&source] {
+            auto copy(source);
+            static_cast<void>(copy);
+        });
+    });
+    ReportBulk("operator= (ns/elem)", kind, [](const auto &source, const FaultPoint &fault) {
+        std::remove_cv_t<std::remove_reference_t<decltype(source)>> receiver;
+        receiver.push_front(*source.begin());
+        fault.Invoke([&receiver, &source] {
+            receiver = source;
+        });
+    });
+    ReportBulk("assign (ns/elem)", kind, [](const auto &source, const FaultPoint &fault) {
+        std::remove_cv_t<std::remove_reference_t<decltype(source)>> receiver;
+        fault.Invoke([&receiver, &source] {
+            receiver.assign(source.begin(), source.end());
+        });
+    });
+}
+
+}  // namespace
+
+int main() {
+    std::cout << "plain: SingleLinkedList<int> without instrumentation; success: instrumented list, no fault;" << std::endl
+              << "fail@1: whole call that fails on the first operation (ns); "
+              << "fail@50%: call that fails halfway, per completed element" << std::endl << std::endl;
+    Report(FaultKind::kAllocation);
+    std::cout << std::endl;
+    Report(FaultKind::kCopy);
+}
@@ -5,5 +5,9 @@
 int main() {
     std::cout << "Start: Testing..." << std::endl;
     TestLinkedList();
+    TestThreadCachingNodeAllocator();
+    TestConcurrentSortedList();
+    TestConstexprSingleLinkedList();
+    TestFaultInjection();
     std::cout << "End: All tests passed successfully.";
 }
\ No newline at end of file
@@ -1,17 +1,39 @@
 #pragma once
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
+#include <initializer_list>
 #include <iterator>
+#include <stdexcept>
+#include <utility>
 
-template <typename Type>
+struct DefaultNodeAllocator {
+    template <typename Node, typename... Args>
+    static constexpr Node *Create(Args &&... args) {
+        return new Node(std::forward<Args>(args)...);
+    }
+
+    template <typename Node>
+    static constexpr void Destroy(Node *node) noexcept {
+        delete node;
+    }
+};
+
+template <typename Type, size_t N>
+class StaticSingleLinkedList;
+
+template <typename Type, typename NodeAllocator = DefaultNodeAllocator>
 class SingleLinkedList {
+    template <typename, size_t>
+    friend class StaticSingleLinkedList;
+
     struct Node {
-        Node() = default;
+        constexpr Node() = default;
 
-        Node(const Type &val, Node *next) : value(val), next_node(next) {}
+        constexpr Node(const Type &val, Node *next) : value(val), next_node(next) {}
 
-        Type value;
+        Type value{};
         Node *next_node = nullptr;
     };
 
@@ -19,7 +41,10 @@ class SingleLinkedList {
     class BasicIterator {
         friend class SingleLinkedList;
 
-        explicit BasicIterator(Node *node)
+        template <typename, size_t>
+        friend class StaticSingleLinkedList;
+
+        constexpr explicit BasicIterator(Node *node)
                 : node_(node) {
         }
 
@@ -30,48 +55,48 @@ class SingleLinkedList {
         using pointer = ValueType *;
         using reference = ValueType &;
 
-        BasicIterator() = default;
+        constexpr BasicIterator() = default;
 
-        BasicIterator(const BasicIterator<Type> &other) noexcept
+        constexpr BasicIterator(const BasicIterator<Type> &other) noexcept
                 : node_(other.node_) {
         }
 
-        BasicIterator &operator=(const BasicIterator &rhs) = default;
+        constexpr BasicIterator &operator=(const BasicIterator &rhs) = default;
 
-        [[nodiscard]] bool operator==(const BasicIterator<Type> &rhs) const noexcept {
+        [[nodiscard]] constexpr bool operator==(const BasicIterator<Type> &rhs) const noexcept {
             return node_ == rhs.node_;
         }
 
-        [[nodiscard]] bool operator!=(const BasicIterator<Type> &rhs) const noexcept {
+        [[nodiscard]] constexpr bool operator!=(const BasicIterator<Type> &rhs) const noexcept {
             return !(*this == rhs);
         }
 
-        [[nodiscard]] bool operator==(const BasicIterator<const Type> &rhs) const noexcept {
+        [[nodiscard]] constexpr bool operator==(const BasicIterator<const Type> &rhs) const noexcept {
             return node_ == rhs.node_;
         }
 
-        [[nodiscard]] bool operator!=(const BasicIterator<const Type> &rhs) const noexcept {
+        [[nodiscard]] constexpr bool operator!=(const BasicIterator<const Type> &rhs) const noexcept {
             return !(*this == rhs);
         }
 
-        BasicIterator &operator++() {
+        constexpr BasicIterator &operator++() {
             assert(node_);
             node_ = node_->next_node;
             return *this;
         }
 
-        BasicIterator operator++(int) {
+        constexpr BasicIterator operator++(int) {
             auto this_copy(*this);
             ++(*this);
             return this_copy;
         }
 
-        [[nodiscard]] reference operator*() const {
+        [[nodiscard]] constexpr reference operator*() const {
             assert(node_);
             return node_->value;
         }
 
-        [[nodiscard]] pointer operator->() const {
+        [[nodiscard]] constexpr pointer operator->() const {
             assert(node_);
             return &node_->value;
         }
@@ -88,21 +113,21 @@ public:
     using Iterator = BasicIterator<Type>;
     using ConstIterator = BasicIterator<const Type>;
 
-    SingleLinkedList() = default;
+    constexpr SingleLinkedList() = default;
 
-    SingleLinkedList(std::initializer_list<Type> values) {
+    constexpr SingleLinkedList(std::initializer_list<Type> values) {
         assign(values.begin(), values.end());
     }
 
-    SingleLinkedList(const SingleLinkedList &other) : SingleLinkedList() {
+    constexpr SingleLinkedList(const SingleLinkedList &other) : SingleLinkedList() {
         assign(other.begin(), other.end());
     }
 
-    ~SingleLinkedList() {
+    constexpr ~SingleLinkedList() {
         clear();
     }
 
-    SingleLinkedList &operator=(const SingleLinkedList &other) {
+    constexpr SingleLinkedList &operator=(const SingleLinkedList &other) {
         if (this != &other) {
             SingleLinkedList temp(other);
             this->swap(temp);
@@ -110,94 +135,92 @@ public:
         return *this;
     }
 
-    Iterator begin() noexcept {
+    constexpr Iterator begin() noexcept {
         return Iterator(head_.next_node);
     }
 
-    Iterator end() noexcept {
+    constexpr Iterator end() noexcept {
         return Iterator(nullptr);
     }
 
-    ConstIterator begin() const noexcept {
+    constexpr ConstIterator begin() const noexcept {
         return cbegin();
     }
 
-    ConstIterator end() const noexcept {
+    constexpr ConstIterator end() const noexcept {
         return cend();
     }
 
-    ConstIterator cbegin() const noexcept {
+    constexpr ConstIterator cbegin() const noexcept {
         return ConstIterator(head_.next_node);
     }
 
-    ConstIterator cend() const noexcept {
+    constexpr ConstIterator cend() const noexcept {
         return ConstIterator(nullptr);
     }
 
-    Iterator before_begin() noexcept {
+    constexpr Iterator before_begin() noexcept {
         return Iterator(&head_);
     }
 
-    ConstIterator before_begin() const noexcept {
+    constexpr ConstIterator before_begin() const noexcept {
         return ConstIterator(&head_);
     }
 
-    ConstIterator cbefore_begin() const noexcept {
+    constexpr ConstIterator cbefore_begin() const noexcept {
         return ConstIterator(const_cast<Node *>(&head_));
     }
 
-    [[nodiscard]] size_t size() const noexcept {
+    [[nodiscard]] constexpr size_t size() const noexcept {
         return size_;
     }
 
-    [[nodiscard]] bool empty() const noexcept {
+    [[nodiscard]] constexpr bool empty() const noexcept {
         return size_ == 0;
     }
 
-    void push_front(const Type &value) {
-        head_.next_node = new Node(value, head_.next_node);
+    constexpr void push_front(const Type &value) {
+        head_.next_node = NodeAllocator::template Create<Node>(value, head_.next_node);
         ++size_;
     }
 
-    Iterator insert_after(ConstIterator pos, const Type &value) {
+    constexpr Iterator insert_after(ConstIterator pos, const Type &value) {
         auto &prev_node = pos.node_;
         assert(prev_node);
-        prev_node->next_node = new Node(value, prev_node->next_node);
+        prev_node->next_node = NodeAllocator::template Create<Node>(value, prev_node->next_node);
         ++size_;
         return Iterator{prev_node->next_node};
     }
 
-    void pop_front() noexcept {
+    constexpr void pop_front() noexcept {
         assert(head_.next_node != nullptr);
         erase_after(before_begin());
 
     }
 
-    Iterator erase_after(ConstIterator pos) noexcept {
+    constexpr Iterator erase_after(ConstIterator pos) noexcept {
         Node *removed_node = pos.node_->next_node;
         pos.node_->next_node = removed_node->next_node;
-        delete removed_node;
+        NodeAllocator::Destroy(removed_node);
         --size_;
         return Iterator(pos.node_->next_node);
     }
 
-    void clear() noexcept {
+    constexpr void clear() noexcept {
         while (head_.next_node) {
-            delete std::exchange(head_.next_node, head_.next_node->next_node);
+            NodeAllocator::Destroy(std::exchange(head_.next_node, head_.next_node->next_node));
             --size_;
         }
     }
 
-    void swap(SingleLinkedList &other) noexcept {
+    constexpr void swap(SingleLinkedList &other) noexcept {
         std::swap(head_.next_node, other.head_.next_node);
         std::swap(size_, other.size_);
     }
 
-
-private:
     template<typename InputIterator>
-    void assign(InputIterator from, InputIterator to) {
-        SingleLinkedList<Type> tmp;
+    constexpr void assign(InputIterator from, InputIterator to) {
+        SingleLinkedList tmp;
         auto node_ptr = tmp.before_begin();
 
         while (from != to) {
@@ -207,43 +230,152 @@ private:
         swap(tmp);
     }
 
+private:
     Node head_;
     size_t size_ = 0;
 };
 
-template <typename Type>
-void swap(SingleLinkedList<Type>& lhs, SingleLinkedList<Type>& rhs) noexcept {
+template <typename Type, typename NodeAllocator>
+constexpr void swap(SingleLinkedList<Type, NodeAllocator>& lhs, SingleLinkedList<Type, NodeAllocator>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
-template <typename Type>
-bool operator==(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
+template <typename Type, typename NodeAllocator>
+constexpr bool operator==(const SingleLinkedList<Type, NodeAllocator>& lhs, const SingleLinkedList<Type, NodeAllocator>& rhs) {
     return (&lhs == &rhs)
            || (lhs.size() == rhs.size()
                && std::equal(lhs.begin(), lhs.end(), rhs.begin()));
 }
 
-template <typename Type>
-bool operator!=(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
+template <typename Type, typename NodeAllocator>
+constexpr bool operator!=(const SingleLinkedList<Type, NodeAllocator>& lhs, const SingleLinkedList<Type, NodeAllocator>& rhs) {
     return !(lhs == rhs);
 }
 
-template <typename Type>
-bool operator<(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
+template <typename Type, typename NodeAllocator>
+constexpr bool operator<(const SingleLinkedList<Type, NodeAllocator>& lhs, const SingleLinkedList<Type, NodeAllocator>& rhs) {
     return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <typename Type>
-bool operator<=(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
+template <typename Type, typename NodeAllocator>
+constexpr bool operator<=(const SingleLinkedList<Type, NodeAllocator>& lhs, const SingleLinkedList<Type, NodeAllocator>& rhs) {
     return !(rhs < lhs);
 }
 
-template <typename Type>
-bool operator>(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
+template <typename Type, typename NodeAllocator>
+constexpr bool operator>(const SingleLinkedList<Type, NodeAllocator>& lhs, const SingleLinkedList<Type, NodeAllocator>& rhs) {
     return (rhs < lhs);
 }
 
-template <typename Type>
-bool operator>=(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
+template <typename Type, typename NodeAllocator>
+constexpr bool operator>=(const SingleLinkedList<Type, NodeAllocator>& lhs, const SingleLinkedList<Type, NodeAllocator>& rhs) {
     return !(lhs < rhs);
+}
+
+template <typename Type, size_t N>
+class StaticSingleLinkedList {
+    using Node = typename SingleLinkedList<Type>::Node;
+
+public:
+    using value_type = Type;
+    using const_reference = const value_type &;
+
+    using ConstIterator = typename SingleLinkedList<Type>::ConstIterator;
+
+    constexpr StaticSingleLinkedList() = default;
+
+    constexpr StaticSingleLinkedList(std::initializer_list<Type> values) {
+        assign(values.begin(), values.end());
+    }
+
+    constexpr StaticSingleLinkedList(const StaticSingleLinkedList &other) {
+        assign(other.begin(), other.end());
+    }
+
+    constexpr StaticSingleLinkedList &operator=(const StaticSingleLinkedList &other) {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    constexpr ConstIterator begin() const noexcept {
+        return cbegin();
+    }
+
+    constexpr ConstIterator end() const noexcept {
+        return cend();
+    }
+
+    constexpr ConstIterator cbegin() const noexcept {
+        return ConstIterator(head_.next_node);
+    }
+
+    constexpr ConstIterator cend() const noexcept {
+        return ConstIterator(nullptr);
+    }
+
+    constexpr ConstIterator before_begin() const noexcept {
+        return cbefore_begin();
+    }
+
+    constexpr ConstIterator cbefore_begin() const noexcept {
+        return ConstIterator(const_cast<Node *>(&head_));
+    }
+
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    [[nodiscard]] static constexpr size_t capacity() noexcept {
+        return N;
+    }
+
+    template<typename InputIterator>
+    constexpr void assign(InputIterator from, InputIterator to) {
+        const size_t old_size = size_;
+        head_.next_node = nullptr;
+        size_ = 0;
+        Node *prev_node = &head_;
+        while (from != to) {
+            if (size_ == N) {
+                throw std::length_error("StaticSingleLinkedList capacity exceeded");
+            }
+            Node &node = nodes_[size_];
+            node.value = *from;
+            node.next_node = nullptr;
+            prev_node->next_node = &node;
+            prev_node = &node;
+            ++size_;
+            ++from;
+        }
+        // Узлы за концом списка не должны удерживать старые значения
+        for (size_t i = size_; i < old_size; ++i) {
+            nodes_[i].value = Type{};
+        }
+    }
+
+private:
+    Node head_;
+    std::array<Node, N> nodes_;
+    size_t size_ = 0;
+};
+
+template <typename Type, typename... Types>
+StaticSingleLinkedList(Type, Types...) -> StaticSingleLinkedList<Type, 1 + sizeof...(Types)>;
+
+template <typename Type, size_t N>
+constexpr bool operator==(const StaticSingleLinkedList<Type, N>& lhs, const StaticSingleLinkedList<Type, N>& rhs) {
+    return (&lhs == &rhs)
+           || (lhs.size() == rhs.size()
+               && std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <typename Type, size_t N>
+constexpr bool operator!=(const StaticSingleLinkedList<Type, N>& lhs, const StaticSingleLinkedList<Type, N>& rhs) {
+    return !(lhs == rhs);
 }
\ No newline at end of file
@@ -1,12 +1,21 @@
 #pragma once
 
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <iterator>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
+#include "concurrent_sorted_list.h"
+#include "fault_injection.h"
 #include "single_linked_list.h"
+#include "thread_caching_node_allocator.h"
 
 void TestLinkedList() {
     std::cout << "TestLinkedList" << std::endl;
@@ -480,4 +489,644 @@ void TestLinkedList() {
         }
     }
     std::cout << "Done!" << std::endl;
-}
\ No newline at end of file
+}
+
+void TestThreadCachingNodeAllocator() {
+    std::cout << "TestThreadCachingNodeAllocator" << std::endl;
+    // Маленькая пачка, чтобы чаще срабатывали обмены с общим пулом
+    using CachingList = SingleLinkedList<int, ThreadCachingNodeAllocator<4>>;
+    using StringCachingList = SingleLinkedList<std::string, ThreadCachingNodeAllocator<4>>;
+
+    // Базовые операции
+    {
+        CachingList list{1, 2, 3};
+        list.push_front(0);
+        list.insert_after(list.cbegin(), 5);
+        assert((list == CachingList{0, 5, 1, 2, 3}));
+        list.erase_after(list.cbegin());
+        list.pop_front();
+        assert((list == CachingList{1, 2, 3}));
+
+        CachingList copy(list);
+        assert(copy == list);
+        list.clear();
+        assert(list.empty());
+        assert(copy.size() == 3);
+    }
+
+    // Повторное использование узлов после множества выделений и освобождений
+    {
+        StringCachingList list;
+        for (int round = 0; round < 10; ++round) {
+            for (int i = 0; i < 100; ++i) {
+                list.push_front(std::to_string(i));
+            }
+            assert(list.size() == 100);
+            assert(*list.begin() == "99");
+            list.clear();
+        }
+    }
+
+    // Узлы, выделенные в одном потоке, освобождаются в другом
+    {
+        std::vector<CachingList> lists(8);
+        std::thread producer([&lists] {
+            for (auto &list : lists) {
+                for (int i = 0; i < 1000; ++i) {
+                    list.push_front(i);
+                }
+            }
+        });
+        producer.join();
+
+        std::thread consumer([&lists] {
+            for (auto &list : lists) {
+                assert(list.size() == 1000);
+                assert(*list.begin() == 999);
+                list.clear();
+            }
+            // Освобождённые здесь узлы переиспользуются этим же потоком
+            CachingList list;
+            for (int i = 0; i < 1000; ++i) {
+                list.push_front(i);
+            }
+            assert(list.size() == 1000);
+        });
+        consumer.join();
+    }
+
+    // Одновременная работа нескольких потоков
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([t] {
+                for (int round = 0; round < 50; ++round) {
+                    CachingList list;
+                    for (int i = 0; i < 200; ++i) {
+                        list.push_front(t * 1000 + i);
+                    }
+                    int expected = t * 1000 + 199;
+                    for ([[maybe_unused]] int value : list) {
+                        assert(value == expected);
+                        --expected;
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+
+    // При исключении в конструкторе элемента узел возвращается в кэш, а список не меняется
+    {
+        struct ThrowingCopy {
+            ThrowingCopy() = default;
+
+            ThrowingCopy(const ThrowingCopy &other)
+                    : do_throw(other.do_throw) {
+                if (do_throw) {
+                    throw std::bad_alloc();
+                }
+            }
+
+            bool do_throw = false;
+        };
+
+        SingleLinkedList<ThrowingCopy, ThreadCachingNodeAllocator<4>> list;
+        list.push_front(ThrowingCopy{});
+        ThrowingCopy thrower;
+        thrower.do_throw = true;
+        for (int i = 0; i < 10; ++i) {
+            try {
+                list.push_front(thrower);
+                assert(false);
+            } catch (const std::bad_alloc &) {
+                assert(list.size() == 1);
+            }
+        }
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+template <typename Strategy>
+void TestConcurrentSortedListStrategy() {
+    using IntSet = ConcurrentSortedList<int, Strategy>;
+
+    // Однопоточная проверка операций множества
+    {
+        IntSet set;
+        assert(set.empty());
+        assert(!set.contains(1));
+        assert(!set.erase(1));
+
+        assert(set.insert(5));
+        assert(set.insert(1));
+        assert(set.insert(3));
+        assert(!set.insert(3));
+        assert(set.size() == 3);
+        assert(set.contains(1) && set.contains(3) && set.contains(5));
+        assert(!set.contains(0) && !set.contains(2) && !set.contains(4) && !set.contains(6));
+
+        assert(set.erase(3));
+        assert(!set.erase(3));
+        assert(!set.contains(3));
+        assert(set.erase(1));
+        assert(set.erase(5));
+        assert(set.empty());
+
+        assert(set.insert(3));
+        assert(set.contains(3));
+    }
+
+    // Проверка удаления элементов при разрушении множества
+    {
+        using namespace std;
+        ConcurrentSortedList<std::string, Strategy> set;
+        assert(set.insert("b"s));
+        assert(set.insert("a"s));
+        assert(set.insert("c"s));
+        assert(set.erase("b"s));
+        assert(set.contains("a"s) && !set.contains("b"s) && set.contains("c"s));
+    }
+
+    constexpr int kThreadCount = 8;
+
+    // Потоки вставляют непересекающиеся наборы ключей вперемешку
+    {
+        constexpr int kKeysPerThread = 500;
+        IntSet set;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreadCount; ++t) {
+            threads.emplace_back([&set, t] {
+                for (int i = 0; i < kKeysPerThread; ++i) {
+                    assert(set.insert(i * kThreadCount + t));
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        assert(set.size() == kThreadCount * kKeysPerThread);
+        for (int key = 0; key < kThreadCount * kKeysPerThread; ++key) {
+            assert(set.contains(key));
+        }
+        assert(!set.contains(-1));
+        assert(!set.contains(kThreadCount * kKeysPerThread));
+    }
+
+    // Потоки одновременно вставляют и удаляют одни и те же ключи.
+    // Для каждого ключа успешные вставки и удаления должны чередоваться,
+    // поэтому их разность равна 0 или 1 и совпадает с итоговым наличием ключа
+    {
+        constexpr int kKeyCount = 64;
+        constexpr int kOperationsPerThread = 20000;
+        IntSet set;
+        std::vector<std::atomic<int>> balance(kKeyCount);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreadCount; ++t) {
+            threads.emplace_back([&set, &balance, t] {
+                unsigned state = 12345u + t;
+                for (int i = 0; i < kOperationsPerThread; ++i) {
+                    state = state * 1103515245u + 12345u;
+                    const int key = static_cast<int>((state >> 16) % kKeyCount);
+                    if ((state >> 8) & 1) {
+                        if (set.insert(key)) {
+                            ++balance[key];
+                        }
+                    } else if (set.erase(key)) {
+                        --balance[key];
+                    } else {
+                        static_cast<void>(set.contains(key));
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        size_t present = 0;
+        for (int key = 0; key < kKeyCount; ++key) {
+            const int key_balance = balance[key];
+            assert(key_balance == 0 || key_balance == 1);
+            assert(set.contains(key) == (key_balance == 1));
+            present += key_balance;
+        }
+        assert(set.size() == present);
+    }
+
+    // Читатели не должны видеть ключи, которые никогда не удаляются, пропавшими
+    {
+        constexpr int kStableKeyCount = 100;
+        IntSet set;
+        for (int key = 0; key < kStableKeyCount; ++key) {
+            set.insert(key * 2);
+        }
+        std::atomic<bool> stop = false;
+        std::vector<std::thread> writers;
+        for (int t = 0; t < kThreadCount / 2; ++t) {
+            writers.emplace_back([&set, &stop] {
+                while (!stop) {
+                    for (int key = 1; key < kStableKeyCount * 2; key += 2) {
+                        set.insert(key);
+                    }
+                    for (int key = 1; key < kStableKeyCount * 2; key += 2) {
+                        set.erase(key);
+                    }
+                }
+            });
+        }
+        for (int round = 0; round < 200; ++round) {
+            for (int key = 0; key < kStableKeyCount; ++key) {
+                assert(set.contains(key * 2));
+            }
+        }
+        stop = true;
+        for (auto &thread : writers) {
+            thread.join();
+        }
+    }
+}
+
+// Элемент, который подсчитывает свои живые экземпляры
+struct LiveCountedKey {
+    LiveCountedKey() = default;
+
+    LiveCountedKey(int k, std::atomic<long> &live_counter) noexcept
+            : key(k)
+            , live_counter_ptr(&live_counter) {
+        ++*live_counter_ptr;
+    }
+
+    LiveCountedKey(const LiveCountedKey &other) noexcept
+            : key(other.key)
+            , live_counter_ptr(other.live_counter_ptr) {
+        if (live_counter_ptr) {
+            ++*live_counter_ptr;
+        }
+    }
+
+    LiveCountedKey &operator=(const LiveCountedKey &) = delete;
+
+    ~LiveCountedKey() {
+        if (live_counter_ptr) {
+            --*live_counter_ptr;
+        }
+    }
+
+    bool operator<(const LiveCountedKey &rhs) const noexcept {
+        return key < rhs.key;
+    }
+
+    int key = 0;
+    std::atomic<long> *live_counter_ptr = nullptr;
+};
+
+template <typename Strategy>
+void TestConcurrentSortedListMemoryIsBounded() {
+    constexpr int kThreadCount = 4;
+    constexpr int kKeyCount = 32;
+    constexpr int kPairsPerThread = 200000;
+    // Удалённые узлы должны освобождаться по ходу работы, а не копиться до разрушения множества.
+    // Поток, вытесненный посреди операции, задерживает смену эпохи, поэтому запас берётся с учётом
+    // длины кванта планировщика, но он намного меньше общего числа удалений
+    [[maybe_unused]] constexpr long kMaxLiveKeys = kThreadCount * kPairsPerThread / 8;
+
+    std::atomic<long> live_keys = 0;
+    {
+        ConcurrentSortedList<LiveCountedKey, Strategy> set;
+        std::atomic<long> max_live_keys = 0;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreadCount; ++t) {
+            threads.emplace_back([&set, &live_keys, &max_live_keys, t] {
+                for (int i = 0; i < kPairsPerThread; ++i) {
+                    const LiveCountedKey key((i + t) % kKeyCount, live_keys);
+                    set.insert(key);
+                    set.erase(key);
+                    if (i % 1000 == 0) {
+                        long observed = live_keys;
+                        long max_observed = max_live_keys;
+                        while (observed > max_observed
+                               && !max_live_keys.compare_exchange_weak(max_observed, observed)) {
+                        }
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        assert(max_live_keys < kMaxLiveKeys);
+        assert(live_keys < kMaxLiveKeys);
+
+        // После Reclaim живы только элементы множества
+        set.Reclaim();
+        assert(live_keys == static_cast<long>(set.size()));
+    }
+    assert(live_keys == 0);
+}
+
+void TestConcurrentSortedList() {
+    std::cout << "TestConcurrentSortedList" << std::endl;
+    TestConcurrentSortedListStrategy<HandOverHandLocking>();
+    TestConcurrentSortedListStrategy<LazySynchronization>();
+    TestConcurrentSortedListStrategy<LockFreeSynchronization>();
+    TestConcurrentSortedListMemoryIsBounded<LazySynchronization>();
+    TestConcurrentSortedListMemoryIsBounded<LockFreeSynchronization>();
+    std::cout << "Done!" << std::endl;
+}
+
+void TestConstexprSingleLinkedList() {
+    std::cout << "TestConstexprSingleLinkedList" << std::endl;
+
+    // Список, созданный и уничтоженный во время вычисления константного выражения
+    static_assert([] {
+        SingleLinkedList<int> list{1, 2, 3};
+        list.push_front(0);
+        list.insert_after(list.begin(), 10);
+        list.pop_front();
+        list.erase_after(++list.cbegin());
+
+        SingleLinkedList<int> copy;
+        copy = list;
+        int sum = 0;
+        for (int value : copy) {
+            sum += value;
+        }
+        return copy.size() == 3 && copy == SingleLinkedList<int>{10, 1, 3} && sum == 14;
+    }());
+
+    static_assert([] {
+        SingleLinkedList<int> first{1, 2};
+        SingleLinkedList<int> second{3};
+        swap(first, second);
+        first.clear();
+        return first.empty() && second.size() == 2 && first < second;
+    }());
+
+    // Список на статическом массиве узлов полностью строится во время компиляции
+    {
+        static constexpr StaticSingleLinkedList<int, 5> table{1, 2, 3};
+        static_assert(table.size() == 3);
+        static_assert(!table.empty());
+        static_assert(table.capacity() == 5);
+        static_assert(*table.begin() == 1);
+        static_assert(++table.cbefore_begin() == table.cbegin());
+        static_assert([] {
+            int sum = 0;
+            for (int value : table) {
+                sum += value;
+            }
+            return sum;
+        }() == 6);
+        static_assert(std::is_same_v<StaticSingleLinkedList<int, 5>::ConstIterator,
+                                     SingleLinkedList<int>::ConstIterator>);
+
+        static constexpr StaticSingleLinkedList deduced{4, 5, 6, 7};
+        static_assert(std::is_same_v<decltype(deduced), const StaticSingleLinkedList<int, 4>>);
+        static_assert(deduced.size() == 4);
+
+        static constexpr StaticSingleLinkedList<int, 0> empty_table;
+        static_assert(empty_table.empty());
+        static_assert(empty_table.begin() == empty_table.end());
+
+        // Итерирование во время выполнения тем же ConstIterator, что и у SingleLinkedList
+        const SingleLinkedList<int> list{1, 2, 3};
+        assert(std::equal(table.begin(), table.end(), list.begin(), list.end()));
+        [[maybe_unused]] SingleLinkedList<int>::ConstIterator it = table.cbegin();
+        assert(*it == 1);
+        assert(*++it == 2);
+        assert(*++it == 3);
+        assert(++it == table.cend());
+    }
+
+    // Попытка записать больше N элементов не выходит за пределы массива узлов
+    {
+        try {
+            StaticSingleLinkedList<int, 2> table{1, 2, 3, 4};
+            assert(false);
+        } catch (const std::length_error &) {
+        }
+
+        struct Guarded {
+            StaticSingleLinkedList<int, 2> table;
+            int neighbour = 42;
+        } guarded;
+        const SingleLinkedList<int> values{1, 2, 3, 4};
+        try {
+            guarded.table.assign(values.begin(), values.end());
+            assert(false);
+        } catch (const std::length_error &) {
+            assert(guarded.table.size() == 2);
+            assert(std::equal(guarded.table.begin(), guarded.table.end(), std::begin({1, 2})));
+            assert(guarded.neighbour == 42);
+        }
+    }
+
+    // Копия ссылается на собственные узлы
+    {
+        using namespace std;
+        StaticSingleLinkedList<std::string, 3> table{"one"s, "two"s};
+        auto copy(table);
+        assert(copy == table);
+        assert(copy.begin() != table.begin());
+        assert(copy.begin()->length() == 3u);
+
+        StaticSingleLinkedList<std::string, 3> other{"a"s, "b"s, "c"s};
+        other = table;
+        assert(other.size() == 2);
+        assert(other == table);
+        assert(other.begin() != table.begin());
+    }
+
+    // Узлы, оставшиеся за концом после assign, освобождают старые значения
+    {
+        int item_counter = 0;
+        struct Counted {
+            Counted() = default;
+
+            explicit Counted(int &counter) noexcept
+                    : counter_ptr(&counter) {
+                ++*counter_ptr;
+            }
+
+            Counted(const Counted &other) noexcept
+                    : counter_ptr(other.counter_ptr) {
+                if (counter_ptr) {
+                    ++*counter_ptr;
+                }
+            }
+
+            Counted &operator=(const Counted &rhs) noexcept {
+                Release();
+                counter_ptr = rhs.counter_ptr;
+                if (counter_ptr) {
+                    ++*counter_ptr;
+                }
+                return *this;
+            }
+
+            ~Counted() {
+                Release();
+            }
+
+            void Release() noexcept {
+                if (counter_ptr) {
+                    --*counter_ptr;
+                }
+            }
+
+            int *counter_ptr = nullptr;
+        };
+
+        const Counted item(item_counter);
+        StaticSingleLinkedList<Counted, 4> table{item, item, item, item};
+        assert(item_counter == 5);
+        const SingleLinkedList<Counted> one_item{Counted{}};
+        table.assign(one_item.begin(), one_item.end());
+        assert(table.size() == 1);
+        assert(item_counter == 1);
+    }
+    std::cout << "Done!" << std::endl;
+}
+
+void TestFaultInjection() {
+    std::cout << "TestFaultInjection" << std::endl;
+    using List = SingleLinkedList<FaultInjectingValue, FaultInjectingNodeAllocator>;
+    constexpr size_t kSize = 10000;
+
+    for (FaultKind kind : {FaultKind::kAllocation, FaultKind::kCopy}) {
+        // push_front: строгая гарантия
+        {
+            [[maybe_unused]] const size_t operations = ForEachInjectedFault(kind, [](const FaultPoint &fault) {
+                auto list = MakeFaultInjectingList<List>(kSize);
+                const auto before = ToValues(list);
+                const FaultInjectingValue value(-1);
+                if (fault.Invoke([&list, &value] {
+                        list.push_front(value);
+                    })) {
+                    assert(HasValues(list, before));
+                } else {
+                    assert(fault.FailAt() == 0);
+                }
+            });
+            assert(operations == 1);
+        }
+
+        // insert_after в середину списка: строгая гарантия
+        ForEachInjectedFault(kind, [](const FaultPoint &fault) {
+            auto list = MakeFaultInjectingList<List>(kSize);
+            const auto before = ToValues(list);
+            auto pos = list.cbegin();
+            std::advance(pos, kSize / 2);
+            const FaultInjectingValue value(-1);
+            List::Iterator inserted;
+            if (fault.Invoke([&list, &pos, &value, &inserted] {
+                    inserted = list.insert_after(pos, value);
+                })) {
+                assert(HasValues(list, before));
+            } else {
+                assert(fault.FailAt() == 0);
+                assert(inserted->Get() == -1);
+            }
+        });
+
+        // Конструктор копирования: исходный список не меняется, частично созданная копия удаляется
+        {
+            [[maybe_unused]] const size_t operations = ForEachInjectedFault(kind, [](const FaultPoint &fault) {
+                const auto source = MakeFaultInjectingList<List>(kSize);
+                const auto before = ToValues(source);
+                [[maybe_unused]] const bool failed = fault.Invoke([&source] {
+                    List copy(source);
+                    assert(copy == source);
+                });
+                assert(failed == (fault.FailAt() != 0));
+                assert(HasValues(source, before));
+            });
+            assert(operations == kSize);
+        }
+
+        // Присваивание: строгая гарантия для списка-приёмника
+        ForEachInjectedFault(kind, [](const FaultPoint &fault) {
+            const auto source = MakeFaultInjectingList<List>(kSize);
+            auto receiver = MakeFaultInjectingList<List>(kSize / 3);
+            receiver.push_front(FaultInjectingValue(-1));
+            const auto source_before = ToValues(source);
+            const auto receiver_before = ToValues(receiver);
+            if (fault.Invoke([&receiver, &source] {
+                    receiver = source;
+                })) {
+                assert(HasValues(receiver, receiver_before));
+            } else {
+                assert(fault.FailAt() == 0);
+                assert(receiver == source);
+            }
+            assert(HasValues(source, source_before));
+        });
+
+        // assign из диапазона: строгая гарантия
+        ForEachInjectedFault(kind, [](const FaultPoint &fault) {
+            const auto source = MakeFaultInjectingList<List>(kSize);
+            auto receiver = MakeFaultInjectingList<List>(kSize / 3);
+            const auto receiver_before = ToValues(receiver);
+            auto from = source.begin();
+            std::advance(from, kSize / 4);
+            if (fault.Invoke([&receiver, &from, &source] {
+                    receiver.assign(from, source.end());
+                })) {
+                assert(HasValues(receiver, receiver_before));
+            } else {
+                assert(fault.FailAt() == 0);
+                assert(receiver.size() == kSize - kSize / 4);
+            }
+        });
+
+        // Конструктор из std::initializer_list
+        ForEachInjectedFault(kind, [](const FaultPoint &fault) {
+            const FaultInjectingValue a(1), b(2), c(3), d(4);
+            [[maybe_unused]] const bool failed = fault.Invoke([&a, &b, &c, &d] {
+                List list{a, b, c, d};
+                assert(list.size() == 4);
+            });
+            assert(failed == (fault.FailAt() != 0));
+        });
+    }
+
+    // Присваивание StaticSingleLinkedList: узлы не выделяются, при сбое копирования - базовая гарантия
+    {
+        constexpr size_t kStaticSize = 1000;
+        using StaticList = StaticSingleLinkedList<FaultInjectingValue, kStaticSize>;
+        ForEachInjectedFault(FaultKind::kCopy, [](const FaultPoint &fault) {
+            const auto values = MakeFaultInjectingList<List>(kStaticSize);
+            auto source = std::make_unique<StaticList>();
+            source->assign(values.begin(), values.end());
+            auto receiver = std::make_unique<StaticList>(std::initializer_list<FaultInjectingValue>{
+                    FaultInjectingValue(-1), FaultInjectingValue(-2)});
+            if (fault.Invoke([&receiver, &source] {
+                    *receiver = *source;
+                })) {
+                assert(IsConsistent(*receiver));
+            } else {
+                assert(fault.FailAt() == 0);
+            }
+        });
+    }
+
+    // Политика с кэшами потоков возвращает узел в кэш при сбое копирования значения
+    {
+        using CachingList = SingleLinkedList<FaultInjectingValue, ThreadCachingNodeAllocator<>>;
+        ForEachInjectedFault(FaultKind::kCopy, [](const FaultPoint &fault) {
+            const auto source = MakeFaultInjectingList<CachingList>(kSize);
+            auto receiver = MakeFaultInjectingList<CachingList>(kSize / 3);
+            const auto receiver_before = ToValues(receiver);
+            if (fault.Invoke([&receiver, &source] {
+                    receiver = source;
+                })) {
+                assert(HasValues(receiver, receiver_before));
+            } else {
+                assert(fault.FailAt() == 0);
+            }
+        });
+    }
+    std::cout << "Done!" << std::endl;
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+
+// Политика выделения узлов с кэшем свободных узлов в каждом потоке.
+// Узлы берутся из общего пула пачками по BatchSize штук, излишки возвращаются туда же пачками,
+// поэтому мьютекс общего пула захватывается не чаще одного раза на BatchSize операций.
+// Узел можно освободить в любом потоке: он просто попадает в кэш освобождающего потока.
+template <size_t BatchSize = 64>
+class ThreadCachingNodeAllocator {
+    static_assert(BatchSize > 0);
+
+public:
+    template <typename Node, typename... Args>
+    static Node *Create(Args &&... args) {
+        void *slot = Pool<Node>::Acquire();
+        try {
+            return new (slot) Node(std::forward<Args>(args)...);
+        } catch (...) {
+            Pool<Node>::Release(slot);
+            throw;
+        }
+    }
+
+    template <typename Node>
+    static void Destroy(Node *node) noexcept {
+        node->~Node();
+        Pool<Node>::Release(node);
+    }
+
+private:
+    template <typename Node>
+    class Pool {
+        union Slot {
+            struct {
+                Slot *next;
+                Slot *next_batch;
+            } link;
+            alignas(Node) unsigned char storage[sizeof(Node)];
+        };
+
+        class SharedPool {
+        public:
+            void Put(Slot *batch) noexcept {
+                std::lock_guard guard(mutex_);
+                batch->link.next_batch = batches_;
+                batches_ = batch;
+            }
+
+            Slot *Take() {
+                {
+                    std::lock_guard guard(mutex_);
+                    if (batches_) {
+                        return std::exchange(batches_, batches_->link.next_batch);
+                    }
+                }
+                Slot *chunk = new Slot[BatchSize];
+                for (size_t i = 0; i + 1 < BatchSize; ++i) {
+                    chunk[i].link.next = &chunk[i + 1];
+                }
+                chunk[BatchSize - 1].link.next = nullptr;
+                return chunk;
+            }
+
+        private:
+            std::mutex mutex_;
+            Slot *batches_ = nullptr;
+        };
+
+        struct LocalCache {
+            ~LocalCache() {
+                cache_destroyed_ = true;
+                if (head) {
+                    Shared().Put(head);
+                }
+            }
+
+            Slot *head = nullptr;
+            size_t count = 0;
+        };
+
+    public:
+        static void *Acquire() {
+            LocalCache *cache = ThisThreadCache();
+            if (!cache) {
+                // Кэш потока уже уничтожен (освобождение во время завершения потока)
+                Slot *batch = Shared().Take();
+                if (batch->link.next) {
+                    Shared().Put(batch->link.next);
+                }
+                return batch;
+            }
+            if (!cache->head) {
+                cache->head = Shared().Take();
+                for (Slot *slot = cache->head; slot; slot = slot->link.next) {
+                    ++cache->count;
+                }
+            }
+            --cache->count;
+            return std::exchange(cache->head, cache->head->link.next);
+        }
+
+        static void Release(void *ptr) noexcept {
+            Slot *slot = static_cast<Slot *>(ptr);
+            LocalCache *cache = ThisThreadCache();
+            if (!cache) {
+                slot->link.next = nullptr;
+                Shared().Put(slot);
+                return;
+            }
+            slot->link.next = cache->head;
+            cache->head = slot;
+            if (++cache->count == 2 * BatchSize) {
+                // Оставляем себе BatchSize узлов, остальные отдаём в общий пул
+                Slot *last_kept = cache->head;
+                for (size_t i = 1; i < BatchSize; ++i) {
+                    last_kept = last_kept->link.next;
+                }
+                Shared().Put(std::exchange(last_kept->link.next, nullptr));
+                cache->count = BatchSize;
+            }
+        }
+
+    private:
+        // Общий пул намеренно не разрушается: списки со статическим временем жизни
+        // могут освобождать узлы уже после разрушения обычных статических объектов
+        static SharedPool &Shared() {
+            static SharedPool *pool = new SharedPool;
+            return *pool;
+        }
+
+        static LocalCache *ThisThreadCache() noexcept {
+            if (cache_destroyed_) {
+                return nullptr;
+            }
+            thread_local LocalCache cache;
+            return &cache;
+        }
+
+        static inline thread_local bool cache_destroyed_ = false;
+    };
+};